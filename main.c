@@ -1,24 +1,88 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mnist.h"
+#include "sweep.h"
 #include <float.h>
 #include <math.h>
 
-int main() {
+// Режим перебора гиперпараметров: датасет загружается один раз и
+// используется всеми конфигурациями, последняя шестая часть - валидация
+static int run_sweep_mode(const SweepConfig *configs, int num_configs, const SweepOptions *options,
+                          MnistRecord *records, int loaded) {
+    SweepResult *results = malloc(num_configs * sizeof(SweepResult));
+    if (!results) {
+        perror("Memory allocation error");
+        return 1;
+    }
+
+    int num_validation = loaded / 6;
+    int num_train = loaded - num_validation;
+    printf("Sweep: %d configurations, %d epochs max, prune margin %.2f%%\n",
+           num_configs, options->epochs, options->prune_margin * 100);
+    printf("Train samples: %d, validation samples: %d\n\n", num_train, num_validation);
+
+    int ok = run_sweep(configs, num_configs, options,
+                       records, num_train, records + num_train, num_validation, results);
+    if (ok) {
+        print_sweep_results(results, num_configs, "sweep_output.txt");
+    }
+
+    free(results);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    // ./mnist_classifier --sweep sweep.txt
+    const char *sweep_file = NULL;
+    if (argc > 1 && strcmp(argv[1], "--sweep") == 0) {
+        if (argc < 3) {
+            fprintf(stderr, "Usage: %s --sweep <sweep_file>\n", argv[0]);
+            return 1;
+        }
+        sweep_file = argv[2];
+    }
+
+    // Файл перебора разбирается до загрузки датасета, чтобы ошибки в нём были видны сразу
+    SweepConfig *sweep_configs = NULL;
+    SweepOptions sweep_options;
+    int num_sweep_configs = 0;
+    if (sweep_file) {
+        sweep_configs = malloc(MAX_SWEEP_CONFIGS * sizeof(SweepConfig));
+        if (!sweep_configs) {
+            perror("Memory allocation error");
+            return 1;
+        }
+        num_sweep_configs = parse_sweep(sweep_file, sweep_configs, MAX_SWEEP_CONFIGS, &sweep_options);
+        if (num_sweep_configs <= 0) {
+            free(sweep_configs);
+            return 1;
+        }
+    }
+
     // 1. Загрузка данных MNIST
     MnistRecord *records = malloc(MAX_RECORDS * sizeof(MnistRecord));
     if (!records) {
         perror("Memory allocation error");
+        free(sweep_configs);
         return 1;
     }
 
     int loaded = load_mnist("mnist_train.csv", records, MAX_RECORDS);
     if (loaded < 0) {
         free(records);
+        free(sweep_configs);
         return 1;
     }
     printf("Loaded %d records from mnist_train.csv\n", loaded);
 
+    if (sweep_file) {
+        int status = run_sweep_mode(sweep_configs, num_sweep_configs, &sweep_options, records, loaded);
+        free(sweep_configs);
+        free(records);
+        return status;
+    }
+
     // 2. Загрузка конфигурации сети
     int *layer_sizes = NULL;
     int num_layers = 0;
@@ -230,6 +230,29 @@ void save_activations(NeuralNetwork* net) {
 }
 
 
+// Выход одного слоя: output = bias + previous * weights (с ReLU для скрытых слоёв).
+// Внешний цикл идёт по входам, чтобы строки матрицы весов читались последовательно.
+static void layer_forward(const Layer *current, const float *previous, int previous_size,
+                          float *output, int apply_relu) {
+    for (int n = 0; n < current->size; n++) {
+        output[n] = current->biases[n];
+    }
+
+    for (int p = 0; p < previous_size; p++) {
+        const float x = previous[p];
+        const float *row = &current->weights[p * current->size];
+        for (int n = 0; n < current->size; n++) {
+            output[n] += x * row[n];
+        }
+    }
+
+    if (apply_relu) {
+        for (int n = 0; n < current->size; n++) {
+            output[n] = ReLU(output[n]);
+        }
+    }
+}
+
 float* forward_pass(NeuralNetwork *net, const float *input) {
 
     const float* effective_input = input;
@@ -246,37 +269,11 @@ float* forward_pass(NeuralNetwork *net, const float *input) {
         net->layers[0].output[i] = effective_input[i];
     }
 
-    // Вычисляем выходы для каждого слоя
-    for (int l = 1; l < net->num_layers-1; l++) {
-        Layer *current = &net->layers[l];
+    // Вычисляем выходы для каждого слоя (последний - без ReLU)
+    for (int l = 1; l < net->num_layers; l++) {
         Layer *previous = &net->layers[l-1];
-        
-        for (int n = 0; n < current->size; n++) {
-            // Вычисляем взвешенную сумму
-            float sum = current->biases[n];
-            
-            for (int p = 0; p < previous->size; p++) {
-                sum += previous->output[p] * current->weights[p * current->size + n];
-            }
-            
-            current->output[n] = ReLU(sum);
-        }
-    }
-
-    // последний слой
-    int l = net->num_layers-1;
-    Layer *current = &net->layers[l];
-    Layer *previous = &net->layers[l-1];
-    
-    for (int n = 0; n < current->size; n++) {
-        // Вычисляем взвешенную сумму
-        float sum = current->biases[n];
-        
-        for (int p = 0; p < previous->size; p++) {
-            sum += previous->output[p] * current->weights[p * current->size + n];
-        }
-        
-        current->output[n] = sum;
+        layer_forward(&net->layers[l], previous->output, previous->size,
+                      net->layers[l].output, l < net->num_layers-1);
     }
     softmax(net->layers[net->num_layers-1].output, net->layers[net->num_layers-1].size);
 
@@ -287,6 +284,70 @@ float* forward_pass(NeuralNetwork *net, const float *input) {
     return net->layers[net->num_layers-1].output;
 }
 
+// Контекст вывода: буферы активаций для всех слоёв, кроме входного, в одном блоке памяти
+InferenceContext* create_inference_context(const NeuralNetwork *net) {
+    InferenceContext *ctx = malloc(sizeof(InferenceContext));
+    if (!ctx) return NULL;
+
+    int total_neurons = 0;
+    for (int l = 1; l < net->num_layers; l++) {
+        total_neurons += net->layers[l].size;
+    }
+
+    ctx->num_layers = net->num_layers;
+    ctx->sizes = malloc(net->num_layers * sizeof(int));
+    ctx->activations = malloc(net->num_layers * sizeof(float*));
+    ctx->buffer = malloc(total_neurons * sizeof(float));
+    if (!ctx->sizes || !ctx->activations || !ctx->buffer) {
+        free(ctx->sizes);
+        free(ctx->activations);
+        free(ctx->buffer);
+        free(ctx);
+        return NULL;
+    }
+
+    ctx->activations[0] = NULL;  // входом служит массив, переданный в forward_inference
+    float *next = ctx->buffer;
+    for (int l = 0; l < net->num_layers; l++) {
+        ctx->sizes[l] = net->layers[l].size;
+    }
+    for (int l = 1; l < net->num_layers; l++) {
+        ctx->activations[l] = next;
+        next += net->layers[l].size;
+    }
+    return ctx;
+}
+
+void free_inference_context(InferenceContext *ctx) {
+    if (!ctx) return;
+    free(ctx->sizes);
+    free(ctx->activations);
+    free(ctx->buffer);
+    free(ctx);
+}
+
+// Прямой проход без записи в сеть: веса только читаются, активации пишутся в контекст
+const float* forward_inference(const NeuralNetwork *net, InferenceContext *ctx, const float *input) {
+    // Контекст другой архитектуры не подходит: его буферы могут быть меньше нужного
+    if (ctx->num_layers != net->num_layers) return NULL;
+    for (int l = 0; l < net->num_layers; l++) {
+        if (ctx->sizes[l] != net->layers[l].size) return NULL;
+    }
+
+    const float *previous = input;
+    int previous_size = net->layers[0].size;
+
+    for (int l = 1; l < net->num_layers; l++) {
+        layer_forward(&net->layers[l], previous, previous_size,
+                      ctx->activations[l], l < net->num_layers-1);
+        previous = ctx->activations[l];
+        previous_size = net->layers[l].size;
+    }
+    softmax(ctx->activations[net->num_layers-1], net->layers[net->num_layers-1].size);
+
+    return ctx->activations[net->num_layers-1];
+}
+
 void backpropagation(
     NeuralNetwork *net,
     const float *input,
@@ -349,6 +410,56 @@ for (int l = net->num_layers-1; l >= 1; l--) {
 }
 }
 
+// Обучение сети: несколько эпох обратного распространения по всему набору
+void train_network(NeuralNetwork *net, const MnistRecord *data, int num_samples, int epochs) {
+    // Буфер градиентов (сумма размеров всех слоёв, кроме входного) выделяется один раз
+    int total_neurons = 0;
+    for (int l = 1; l < net->num_layers; l++) {
+        total_neurons += net->layers[l].size;
+    }
+    float *gradients = malloc(total_neurons * sizeof(float));
+    if (!gradients) {
+        perror("Failed to allocate gradients");
+        return;
+    }
+
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        for (int i = 0; i < num_samples; i++) {
+            backpropagation(net, data[i].pixels, data[i].label, gradients);
+        }
+    }
+
+    free(gradients);
+}
+
+// Оценка точности: доля примеров, где класс с максимальной вероятностью совпал с меткой
+float evaluate_network(const NeuralNetwork *net, const MnistRecord *data, int num_samples) {
+    if (num_samples <= 0) return 0.0f;
+
+    // Собственный контекст: сеть не изменяется, её можно оценивать из нескольких потоков
+    InferenceContext *ctx = create_inference_context(net);
+    if (!ctx) {
+        perror("Failed to allocate inference context");
+        return 0.0f;
+    }
+
+    int output_size = net->layers[net->num_layers-1].size;
+    int correct = 0;
+    for (int i = 0; i < num_samples; i++) {
+        const float *output = forward_inference(net, ctx, data[i].pixels);
+        if (!output) break;
+
+        int predicted = 0;
+        for (int j = 1; j < output_size; j++) {
+            if (output[j] > output[predicted]) predicted = j;
+        }
+        if (predicted == data[i].label) correct++;
+    }
+
+    free_inference_context(ctx);
+    return (float)correct / num_samples;
+}
+
 // Функция для сохранения весов в бинарный файл
 void save_weights(NeuralNetwork *net, const char *filename) {
     FILE *file = fopen(filename, "wb");
@@ -29,6 +29,14 @@ typedef struct {
     float regularization;   // Коэффициент L2-регуляризации
 } NeuralNetwork;
 
+/* Контекст вывода: активации одного потока, веса берутся из общей сети */
+typedef struct {
+    int num_layers;         // Количество слоёв сети
+    int *sizes;             // Размеры слоёв сети, для которой создан контекст
+    float **activations;    // Выходы слоёв (activations[0] не используется)
+    float *buffer;          // Общий блок памяти под все активации
+} InferenceContext;
+
 
 /* Функции для работы с MNIST */
 
@@ -113,6 +121,32 @@ void add_noise(float *pixels, int size, float noise_level);
  */
 float* forward_pass(NeuralNetwork *net, const float *input);
 
+/**
+ * Создаёт контекст вывода с буферами активаций для указанной сети.
+ * Каждый поток использует собственный контекст, а сеть остаётся общей.
+ * @param net Указатель на нейронную сеть.
+ * @return Указатель на контекст или NULL при ошибке.
+ */
+InferenceContext* create_inference_context(const NeuralNetwork *net);
+
+/**
+ * Освобождает память, занятую контекстом вывода.
+ * @param ctx Указатель на контекст.
+ */
+void free_inference_context(InferenceContext *ctx);
+
+/**
+ * Потокобезопасный прямой проход: сеть только читается, активации пишутся в контекст.
+ * Несколько потоков могут одновременно использовать одну сеть с разными контекстами,
+ * пока её никто не обучает.
+ * @param net Указатель на нейронную сеть.
+ * @param ctx Контекст вывода текущего потока.
+ * @param input Массив входных данных (пиксели).
+ * @return Массив выходных активаций последнего слоя (принадлежит контексту)
+ *         или NULL, если контекст создан для сети другой архитектуры.
+ */
+const float* forward_inference(const NeuralNetwork *net, InferenceContext *ctx, const float *input);
+
 /**
  * Обучает нейронную сеть на датасете MNIST.
  * @param net Указатель на нейронную сеть.
@@ -120,16 +154,17 @@ float* forward_pass(NeuralNetwork *net, const float *input);
  * @param num_samples Количество записей для обучения.
  * @param epochs Количество эпох обучения.
  */
-void train_network(NeuralNetwork *net, MnistRecord *data, int num_samples, int epochs);
+void train_network(NeuralNetwork *net, const MnistRecord *data, int num_samples, int epochs);
 
 /**
  * Оценивает точность нейронной сети на тестовом датасете.
+ * Использует собственный контекст вывода и не изменяет сеть.
  * @param net Указатель на нейронную сеть.
  * @param data Массив тестовых записей MNIST.
  * @param num_samples Количество тестовых записей.
  * @return Доля правильно классифицированных примеров (точность).
  */
-float evaluate_network(NeuralNetwork *net, MnistRecord *data, int num_samples);
+float evaluate_network(const NeuralNetwork *net, const MnistRecord *data, int num_samples);
 
 /**
  * Выполняет обратное распространение ошибки для обновления весов.
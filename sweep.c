@@ -0,0 +1,436 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "sweep.h"
+
+// Значения по умолчанию совпадают с main.c
+static const int default_layers[] = {784, 256, 10};
+#define DEFAULT_LEARNING_RATE 0.01f
+#define DEFAULT_REGULARIZATION 0.001f
+
+// Читает список чисел через запятую/пробел, возвращает их количество или -1
+static int parse_float_list(const char *s, float *values, int max_values) {
+    int count = 0;
+    while (*s) {
+        if (*s == ',' || *s == ' ' || *s == '\t' || *s == '\r') {
+            s++;
+            continue;
+        }
+        char *end;
+        float value = strtof(s, &end);
+        if (end == s || count >= max_values) return -1;
+        values[count++] = value;
+        s = end;
+    }
+    return count;
+}
+
+// Читает одну архитектуру ("784, 256, 10") до символа '|' или конца строки
+static int parse_layer_list(const char *s, const char **rest, int *layers) {
+    int count = 0;
+    while (*s && *s != '|') {
+        if (*s == ',' || *s == ' ' || *s == '\t' || *s == '\r') {
+            s++;
+            continue;
+        }
+        char *end;
+        long size = strtol(s, &end, 10);
+        if (end == s || size <= 0 || count >= MAX_SWEEP_LAYERS) return -1;
+        layers[count++] = (int)size;
+        s = end;
+    }
+    *rest = s;
+    return count;
+}
+
+// Читает одно целое число после ключа, возвращает 1 при успехе
+static int parse_int_value(const char *s, int *value) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (end == s) return 0;
+    while (*end == ' ' || *end == '\t') end++;
+    if (*end) return 0;
+    *value = (int)v;
+    return 1;
+}
+
+// Читает одно вещественное число после ключа, возвращает 1 при успехе
+static int parse_float_value(const char *s, float *value) {
+    char *end;
+    float v = strtof(s, &end);
+    if (end == s) return 0;
+    while (*end == ' ' || *end == '\t') end++;
+    if (*end) return 0;
+    *value = v;
+    return 1;
+}
+
+/* Состояние одной секции файла перебора */
+typedef struct {
+    int layers[MAX_SWEEP_VALUES][MAX_SWEEP_LAYERS];
+    int num_layers[MAX_SWEEP_VALUES];
+    int num_archs;
+    float learning_rates[MAX_SWEEP_VALUES];
+    int num_learning_rates;
+    float regularizations[MAX_SWEEP_VALUES];
+    int num_regularizations;
+} SweepSection;
+
+// Разворачивает секцию в декартово произведение конфигураций
+static int expand_section(SweepSection *section, SweepConfig *configs, int count, int max_configs) {
+    if (section->num_archs == 0) {
+        section->num_layers[0] = sizeof(default_layers) / sizeof(default_layers[0]);
+        memcpy(section->layers[0], default_layers, sizeof(default_layers));
+        section->num_archs = 1;
+    }
+    if (section->num_learning_rates == 0) {
+        section->learning_rates[0] = DEFAULT_LEARNING_RATE;
+        section->num_learning_rates = 1;
+    }
+    if (section->num_regularizations == 0) {
+        section->regularizations[0] = DEFAULT_REGULARIZATION;
+        section->num_regularizations = 1;
+    }
+
+    for (int a = 0; a < section->num_archs; a++) {
+        for (int r = 0; r < section->num_learning_rates; r++) {
+            for (int g = 0; g < section->num_regularizations; g++) {
+                if (count >= max_configs) {
+                    fprintf(stderr, "Ошибка: слишком много конфигураций (максимум %d)\n", max_configs);
+                    return -1;
+                }
+                SweepConfig *config = &configs[count++];
+                config->num_layers = section->num_layers[a];
+                memcpy(config->layers, section->layers[a], config->num_layers * sizeof(int));
+                config->learning_rate = section->learning_rates[r];
+                config->regularization = section->regularizations[g];
+            }
+        }
+    }
+
+    memset(section, 0, sizeof(*section));
+    return count;
+}
+
+int parse_sweep(const char *filename, SweepConfig *configs, int max_configs,
+                SweepOptions *options) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        printf("Ошибка: не удалось открыть %s\n", filename);
+        return -1;
+    }
+
+    options->epochs = 10;
+    options->prune_margin = 0.05f;
+    options->prune_after = 2;
+    options->num_threads = 0;
+
+    SweepSection *section = calloc(1, sizeof(SweepSection));
+    if (!section) {
+        perror("Memory allocation error");
+        fclose(file);
+        return -1;
+    }
+
+    char line[1024];
+    int count = 0;
+    int line_number = 0;
+    int section_used = 0;  // были ли в текущей секции строки с гиперпараметрами
+    int header_done = 0;   // общие параметры допускаются только до первой секции
+
+    while (count >= 0 && fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = 0;
+
+        // общие параметры перебора: только в заголовке файла
+        int is_option = strncmp(line, "epochs:", 7) == 0 ||
+                        strncmp(line, "prune_margin:", 13) == 0 ||
+                        strncmp(line, "prune_after:", 12) == 0 ||
+                        strncmp(line, "threads:", 8) == 0;
+        if (is_option && header_done) {
+            fprintf(stderr, "Ошибка: общий параметр в строке %d должен стоять до первой секции\n", line_number);
+            count = -1;
+        }
+        else if (line[strspn(line, " \t")] == '\0') {
+            continue;  // пустая строка
+        }
+        else if (strncmp(line, "---", 3) == 0) {
+            if (section_used) count = expand_section(section, configs, count, max_configs);
+            section_used = 0;
+            header_done = 1;
+        }
+        else if (strncmp(line, "neurons:", 8) == 0) {
+            if (section->num_archs > 0) {
+                fprintf(stderr, "Ошибка: повторный ключ neurons в секции, строка %d\n", line_number);
+                count = -1;
+                continue;
+            }
+            const char *s = line + 8;
+            while (count >= 0) {
+                int n = section->num_archs;
+                if (n >= MAX_SWEEP_VALUES) {
+                    fprintf(stderr, "Ошибка: слишком много архитектур в строке %d\n", line_number);
+                    count = -1;
+                    break;
+                }
+                int num = parse_layer_list(s, &s, section->layers[n]);
+                if (num < 2 || section->layers[n][0] != MAX_FIELDS - 1 ||
+                    section->layers[n][num - 1] != 10) {
+                    fprintf(stderr, "Ошибка: неверная архитектура в строке %d\n", line_number);
+                    count = -1;
+                    break;
+                }
+                section->num_layers[n] = num;
+                section->num_archs++;
+                if (*s != '|') break;
+                s++;
+            }
+            section_used = 1;
+            header_done = 1;
+        }
+        else if (strncmp(line, "learning_rate:", 14) == 0) {
+            if (section->num_learning_rates > 0) {
+                fprintf(stderr, "Ошибка: повторный ключ learning_rate в секции, строка %d\n", line_number);
+                count = -1;
+                continue;
+            }
+            section->num_learning_rates = parse_float_list(line + 14, section->learning_rates, MAX_SWEEP_VALUES);
+            if (section->num_learning_rates <= 0) {
+                fprintf(stderr, "Ошибка: неверный список learning_rate в строке %d\n", line_number);
+                count = -1;
+            }
+            for (int i = 0; count >= 0 && i < section->num_learning_rates; i++) {
+                if (section->learning_rates[i] <= 0) {
+                    fprintf(stderr, "Ошибка: learning_rate должно быть положительным в строке %d\n", line_number);
+                    count = -1;
+                }
+            }
+            section_used = 1;
+            header_done = 1;
+        }
+        else if (strncmp(line, "regularization:", 15) == 0) {
+            if (section->num_regularizations > 0) {
+                fprintf(stderr, "Ошибка: повторный ключ regularization в секции, строка %d\n", line_number);
+                count = -1;
+                continue;
+            }
+            section->num_regularizations = parse_float_list(line + 15, section->regularizations, MAX_SWEEP_VALUES);
+            if (section->num_regularizations <= 0) {
+                fprintf(stderr, "Ошибка: неверный список regularization в строке %d\n", line_number);
+                count = -1;
+            }
+            for (int i = 0; count >= 0 && i < section->num_regularizations; i++) {
+                if (section->regularizations[i] < 0) {
+                    fprintf(stderr, "Ошибка: regularization должно быть неотрицательным в строке %d\n", line_number);
+                    count = -1;
+                }
+            }
+            section_used = 1;
+            header_done = 1;
+        }
+        else if (strncmp(line, "epochs:", 7) == 0) {
+            if (!parse_int_value(line + 7, &options->epochs) || options->epochs <= 0) {
+                fprintf(stderr, "Ошибка: epochs должно быть положительным в строке %d\n", line_number);
+                count = -1;
+            }
+        }
+        else if (strncmp(line, "prune_margin:", 13) == 0) {
+            if (!parse_float_value(line + 13, &options->prune_margin) || options->prune_margin < 0) {
+                fprintf(stderr, "Ошибка: prune_margin должно быть неотрицательным в строке %d\n", line_number);
+                count = -1;
+            }
+        }
+        else if (strncmp(line, "prune_after:", 12) == 0) {
+            if (!parse_int_value(line + 12, &options->prune_after) || options->prune_after < 0) {
+                fprintf(stderr, "Ошибка: prune_after должно быть неотрицательным в строке %d\n", line_number);
+                count = -1;
+            }
+        }
+        else if (strncmp(line, "threads:", 8) == 0) {
+            if (!parse_int_value(line + 8, &options->num_threads) || options->num_threads < 0) {
+                fprintf(stderr, "Ошибка: threads должно быть неотрицательным в строке %d\n", line_number);
+                count = -1;
+            }
+        }
+        else {
+            fprintf(stderr, "Ошибка: неизвестный параметр в строке %d: %s\n", line_number, line);
+            count = -1;
+        }
+    }
+
+    if (count >= 0 && section_used) {
+        count = expand_section(section, configs, count, max_configs);
+    }
+    if (count == 0) {
+        fprintf(stderr, "Ошибка: в %s нет ни одной конфигурации\n", filename);
+        count = -1;
+    }
+
+    free(section);
+    fclose(file);
+    return count;
+}
+
+
+/* Общее состояние пула потоков */
+typedef struct {
+    const SweepConfig *configs;
+    int num_configs;
+    const SweepOptions *options;
+    const MnistRecord *train;
+    int num_train;
+    const MnistRecord *validation;
+    int num_validation;
+    SweepResult *results;
+
+    int next_config;        // следующая конфигурация в очереди
+    float *epoch_best;      // лучшая точность на каждой эпохе среди всех конфигураций
+    pthread_mutex_t lock;
+} SweepState;
+
+static void* sweep_worker(void *arg) {
+    SweepState *state = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&state->lock);
+        int index = state->next_config++;
+        pthread_mutex_unlock(&state->lock);
+        if (index >= state->num_configs) break;
+
+        const SweepConfig *config = &state->configs[index];
+        SweepResult *result = &state->results[index];
+        result->config = *config;
+        result->accuracy = 0.0f;
+        result->epochs_run = 0;
+        result->pruned = 0;
+
+        // create_network вызывает srand()/rand(), поэтому создаём сети по очереди
+        pthread_mutex_lock(&state->lock);
+        NeuralNetwork *net = create_network(config->layers, config->num_layers,
+                                            config->learning_rate, config->regularization);
+        pthread_mutex_unlock(&state->lock);
+        if (!net) continue;
+
+        for (int epoch = 0; epoch < state->options->epochs; epoch++) {
+            train_network(net, state->train, state->num_train, 1);
+            float accuracy = evaluate_network(net, state->validation, state->num_validation);
+            result->accuracy = accuracy;
+            result->epochs_run = epoch + 1;
+
+            pthread_mutex_lock(&state->lock);
+            if (accuracy > state->epoch_best[epoch]) {
+                state->epoch_best[epoch] = accuracy;
+            }
+            int losing = epoch + 1 >= state->options->prune_after &&
+                         accuracy < state->epoch_best[epoch] - state->options->prune_margin;
+            pthread_mutex_unlock(&state->lock);
+
+            printf("Config %d, epoch %d: validation accuracy = %.2f%%%s\n",
+                   index, epoch, accuracy * 100, losing ? " (pruned)" : "");
+            if (losing) {
+                result->pruned = 1;
+                break;
+            }
+        }
+
+        free_network(net);
+    }
+    return NULL;
+}
+
+int run_sweep(const SweepConfig *configs, int num_configs, const SweepOptions *options,
+              const MnistRecord *train, int num_train,
+              const MnistRecord *validation, int num_validation,
+              SweepResult *results) {
+    if (num_configs <= 0) return 0;
+
+    SweepState state = {
+        .configs = configs,
+        .num_configs = num_configs,
+        .options = options,
+        .train = train,
+        .num_train = num_train,
+        .validation = validation,
+        .num_validation = num_validation,
+        .results = results,
+        .next_config = 0,
+    };
+
+    state.epoch_best = malloc(options->epochs * sizeof(float));
+    if (!state.epoch_best) {
+        perror("Memory allocation error");
+        return 0;
+    }
+    for (int i = 0; i < options->epochs; i++) {
+        state.epoch_best[i] = -1.0f;
+    }
+    pthread_mutex_init(&state.lock, NULL);
+
+    // Число потоков: из настроек или по числу доступных ядер
+    int num_threads = options->num_threads;
+    if (num_threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cores > 0 ? (int)cores : 1;
+    }
+    if (num_threads > num_configs) num_threads = num_configs;
+
+    printf("Running %d configurations on %d threads...\n", num_configs, num_threads);
+
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    int started = 0;
+    if (threads) {
+        for (; started < num_threads; started++) {
+            if (pthread_create(&threads[started], NULL, sweep_worker, &state) != 0) break;
+        }
+    }
+    // Если не удалось запустить ни одного потока, обучаем в текущем
+    if (started == 0) sweep_worker(&state);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    pthread_mutex_destroy(&state.lock);
+    free(state.epoch_best);
+    return 1;
+}
+
+
+static int compare_results(const void *a, const void *b) {
+    const SweepResult *ra = a;
+    const SweepResult *rb = b;
+    if (ra->accuracy > rb->accuracy) return -1;
+    if (ra->accuracy < rb->accuracy) return 1;
+    return 0;
+}
+
+static void write_sweep_table(FILE *out, const SweepResult *results, int num_results) {
+    fprintf(out, "%-5s %-9s %-7s %-7s %-10s %-10s %s\n",
+            "Rank", "Accuracy", "Epochs", "Status", "LR", "Reg", "Layers");
+    for (int i = 0; i < num_results; i++) {
+        const SweepResult *r = &results[i];
+        fprintf(out, "%-5d %7.2f%%  %-7d %-7s %-10g %-10g ",
+                i + 1, r->accuracy * 100, r->epochs_run, r->pruned ? "pruned" : "done",
+                r->config.learning_rate, r->config.regularization);
+        for (int l = 0; l < r->config.num_layers; l++) {
+            fprintf(out, "%d ", r->config.layers[l]);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+void print_sweep_results(SweepResult *results, int num_results, const char *filename) {
+    qsort(results, num_results, sizeof(SweepResult), compare_results);
+
+    printf("\nSweep results:\n");
+    write_sweep_table(stdout, results, num_results);
+
+    FILE *file = fopen(filename, "w");
+    if (file) {
+        write_sweep_table(file, results, num_results);
+        fclose(file);
+        printf("Sweep results saved to %s\n", filename);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "mnist.h"
+
+#define MAX_SWEEP_CONFIGS 1024
+#define MAX_SWEEP_LAYERS 16
+#define MAX_SWEEP_VALUES 64
+
+/* Одна конфигурация из сетки перебора гиперпараметров */
+typedef struct {
+    int layers[MAX_SWEEP_LAYERS];   // Размеры слоёв
+    int num_layers;                 // Количество слоёв
+    float learning_rate;            // Скорость обучения
+    float regularization;           // Коэффициент L2-регуляризации
+} SweepConfig;
+
+/* Общие параметры перебора */
+typedef struct {
+    int epochs;             // Максимальное число эпох на конфигурацию
+    float prune_margin;     // Отставание от лучшей точности на той же эпохе, после которого обучение прекращается
+    int prune_after;        // Сколько эпох каждая конфигурация проходит без досрочной остановки
+    int num_threads;        // Число потоков (0 - по числу доступных ядер)
+} SweepOptions;
+
+/* Результат обучения одной конфигурации */
+typedef struct {
+    SweepConfig config;     // Конфигурация
+    float accuracy;         // Точность на валидации после последней эпохи
+    int epochs_run;         // Сколько эпох фактически пройдено
+    int pruned;             // 1, если обучение остановлено досрочно
+} SweepResult;
+
+/**
+ * Читает файл перебора гиперпараметров.
+ * Файл начинается с заголовка с общими параметрами перебора ("epochs:",
+ * "prune_margin:", "prune_after:", "threads:"), которые допускаются только до
+ * первой секции. Дальше идут секции, разделённые строкой "---". Каждая секция
+ * задаёт сетку: в строке "neurons:" архитектуры разделяются '|', в строках
+ * "learning_rate:" и "regularization:" значения разделяются запятыми.
+ * Каждый ключ встречается в секции не больше одного раза.
+ * Конфигурации строятся как декартово произведение значений секции.
+ * Неизвестные ключи, недопустимые значения и файл без секций считаются ошибкой.
+ * @param filename Имя файла перебора.
+ * @param configs Массив для хранения конфигураций.
+ * @param max_configs Максимальное количество конфигураций.
+ * @param options Указатель на общие параметры (заполняются значениями по умолчанию, если не заданы).
+ * @return Количество конфигураций или -1 в случае ошибки.
+ */
+int parse_sweep(const char *filename, SweepConfig *configs, int max_configs,
+                SweepOptions *options);
+
+/**
+ * Обучает все конфигурации параллельно на пуле потоков.
+ * Датасеты загружаются один раз и используются всеми потоками только для чтения.
+ * После каждой эпохи (начиная с prune_after) конфигурация сравнивается с лучшей
+ * точностью на той же эпохе и останавливается, если отстаёт больше чем на prune_margin.
+ * @param configs Массив конфигураций.
+ * @param num_configs Количество конфигураций.
+ * @param options Общие параметры перебора.
+ * @param train Обучающие записи.
+ * @param num_train Количество обучающих записей.
+ * @param validation Валидационные записи.
+ * @param num_validation Количество валидационных записей.
+ * @param results Массив результатов (по одному на конфигурацию).
+ * @return 1 в случае успеха, 0 при ошибке.
+ */
+int run_sweep(const SweepConfig *configs, int num_configs, const SweepOptions *options,
+              const MnistRecord *train, int num_train,
+              const MnistRecord *validation, int num_validation,
+              SweepResult *results);
+
+/**
+ * Сортирует результаты по убыванию точности и выводит сводную таблицу
+ * в консоль и в файл.
+ * @param results Массив результатов.
+ * @param num_results Количество результатов.
+ * @param filename Имя файла для сохранения таблицы.
+ */
+void print_sweep_results(SweepResult *results, int num_results, const char *filename);
+
+#endif